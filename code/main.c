@@ -1,4 +1,14 @@
 #define F_CPU 1000000UL
+
+// [DEBUG] Measure how many CPU cycles the hot functions take (see Profiling
+// below). The statistics are written to EEPROM after every
+// PROFILE_DUMP_INTERVAL locked in positions and can be read with the
+// `dump_profile` target. Note that the timer overflow interrupt slightly
+// distorts the sound, that writing the EEPROM stalls the puzzle for up to half
+// a second (about 8.5 ms per changed byte) and that every write wears the
+// EEPROM. Uncomment next line to activate
+// #define PROFILING
+
 #include <avr/io.h>
 
 // See https://stackoverflow.com/questions/30422367
@@ -9,6 +19,11 @@
 
 #include <util/delay.h>
 
+#ifdef PROFILING
+#include <avr/eeprom.h>
+#include <avr/interrupt.h>
+#endif
+
 // Port definitions
 // -----------------------------------------------------------------------------
 
@@ -60,6 +75,14 @@
 #define LOCKED_IN_DUR 50
 #define LOCKED_IN_BREAK 300
 
+// Songs store frequencies in units of 1 / 2^SONG_FREQ_SHIFT Hz (fixed point)
+#define SONG_FREQ_SHIFT 4
+
+// Tempo scales for play_song are in units of 1 / 2^SONG_TEMPO_SHIFT, i.e.
+// SONG_TEMPO_UNIT plays the song as stored, 2 * SONG_TEMPO_UNIT at half speed.
+#define SONG_TEMPO_SHIFT 4
+#define SONG_TEMPO_UNIT (1 << SONG_TEMPO_SHIFT)
+
 // Debug configuration
 // -----------------------------------------------------------------------------
 
@@ -73,6 +96,9 @@
  */
 #define BEEP_NUMBER_LONG_NUMBER 4
 
+// [DEBUG] The PROFILING switch is at the top of the file because it selects
+// additional includes.
+
 // Puzzle configuration
 // -----------------------------------------------------------------------------
 
@@ -138,6 +164,90 @@ const __flash uint8_t HINT_COMBINATION[5] = {TEN, SMI, WHI, TEN, CAP};
 char *alphabet = "**ETIANMSURWDKGOHVF*L*PJBXCYZQ**";
 #define ALPHABET_LENGTH 32
 
+/**
+ * Frequency factors 2^(k/12) for transposing by k = 0, ..., 11 semitones in
+ * units of 1 / 2^15. Whole octaves are transposed by bit shifts.
+ */
+const __flash uint16_t SEMITONE_FACTORS[12] = {
+    32768, 34716, 36781, 38968, 41285, 43740,
+    46341, 49097, 52016, 55109, 58386, 61858};
+
+// Profiling
+// -----------------------------------------------------------------------------
+
+#ifdef PROFILING
+/**
+ * Number of locked in positions after which the statistics are written to
+ * EEPROM
+ */
+#define PROFILE_DUMP_INTERVAL 10
+
+/**
+ * EEPROM address that profile_dump writes profile_table to
+ */
+#define PROFILE_EEPROM_ADDRESS 0
+
+/**
+ * Profiled functions. Used as index into the profiling table.
+ */
+enum profile_id {
+  PROFILE_BEEP = 0,
+  PROFILE_MORSE_CHAR,
+  PROFILE_GET_WHEEL_POS,
+  PROFILE_PLAY_AUDIO,
+  PROFILE_PUSH_HISTORY,
+  PROFILE_N_FUNCTIONS,
+  // Not a function: measures the overhead of the profiler itself
+  PROFILE_CALIBRATION = PROFILE_N_FUNCTIONS
+};
+
+/**
+ * Statistics of one profiled function. Durations are in CPU cycles and
+ * exclude the profiler's own overhead (see profile_bias). Nested calls (e.g.
+ * the recursion in _morse_char) are counted in the total of every level. The
+ * total saturates instead of overflowing.
+ */
+struct profile_entry {
+  uint32_t count;
+  uint32_t total;
+  uint32_t max;
+};
+
+/**
+ * Statistics of all profiled functions, indexed by enum profile_id
+ */
+struct profile_entry profile_table[PROFILE_N_FUNCTIONS];
+
+/**
+ * Cycles that an empty PROFILE_FUNCTION scope takes. Measured once in
+ * initialize_profiling and subtracted from every measurement.
+ */
+uint16_t profile_bias = 0;
+
+/**
+ * Upper 16 bit of the cycle counter. Timer1 provides the lower 16 bit.
+ */
+volatile uint16_t profile_overflows = 0;
+
+/**
+ * Start of a measurement. Lives on the stack of the profiled function.
+ */
+struct profile_scope {
+  enum profile_id id;
+  uint32_t start;
+};
+
+/**
+ * Put at the start of a function to profile it. The measurement is stopped
+ * automatically whenever the function returns.
+ */
+#define PROFILE_FUNCTION(id)                                                   \
+  struct profile_scope _profile_scope __attribute__((cleanup(profile_stop))) = \
+      {id, profile_now()}
+#else
+#define PROFILE_FUNCTION(id)
+#endif
+
 // PROTOTYPES
 // =============================================================================
 
@@ -176,9 +286,13 @@ void play_fail_sound(int8_t on_position);
 
 /**
  * Play song given as 2d array length x 2. The two values correspond to
- * frequency and duration. A negative duration marks the end of the song.
+ * frequency (in units of 1 / 2^SONG_FREQ_SHIFT Hz) and duration (in ms). A
+ * zero duration marks the end of the song. The song is transposed by
+ * `semitones` and its durations are multiplied by
+ * `tempo_scale / SONG_TEMPO_UNIT`. Only integer math is used for this.
  */
-void play_song(const __flash float song[][2], int8_t on_position);
+void play_song(const __flash uint16_t song[][2], int8_t semitones,
+               uint8_t tempo_scale, int8_t on_position);
 
 // Pre defined songs
 void play_hint(int8_t on_position);
@@ -234,15 +348,47 @@ void beep_number(uint8_t number);
  */
 void beep_history(enum position *history);
 
+#ifdef PROFILING
+/**
+ * Used for profiling: Let Timer1 count every CPU cycle and enable interrupts
+ * to extend it to 32 bit. Then measure profile_bias.
+ */
+void initialize_profiling(void);
+
+/**
+ * Used for profiling: Number of CPU cycles since initialize_profiling. Wraps
+ * after about 70 minutes.
+ */
+uint32_t profile_now(void);
+
+/**
+ * Used for profiling: Record the duration of the measurement started by
+ * PROFILE_FUNCTION.
+ */
+void profile_stop(struct profile_scope *scope);
+
+/**
+ * Used for profiling: Write profile_table to EEPROM at
+ * PROFILE_EEPROM_ADDRESS. Only changed bytes are written.
+ */
+void profile_dump(void);
+#endif
+
 // MAIN
 // =============================================================================
 
 uint8_t main(void) {
   initialize_ports();
+#ifdef PROFILING
+  initialize_profiling();
+#endif
   play_boot_sound();
 
   uint8_t last_position = get_wheel_pos();
   enum position history[HISTORY_LENGTH] = {0, 0, 0, 0, 0, 0};
+#ifdef PROFILING
+  uint8_t lock_in_count = 0;
+#endif
 
   // Wait for first wheel change to start riddle
   while (get_wheel_pos() == last_position) {
@@ -291,6 +437,12 @@ uint8_t main(void) {
             push_history(history, current_pos);
 
           play_audio(history);
+#ifdef PROFILING
+          if (++lock_in_count == PROFILE_DUMP_INTERVAL) {
+            lock_in_count = 0;
+            profile_dump();
+          }
+#endif
         }
       }
     }
@@ -359,6 +511,7 @@ void beep_forever(float freq) {
 // WARNING: When you change this implementation you might have recalibrate
 // DELAY_OVEREAD_US.
 void beep(float freq, float duration, int8_t on_position) {
+  PROFILE_FUNCTION(PROFILE_BEEP);
 
   // low frequency beeps are seen as silence
   if (freq < 1) {
@@ -393,6 +546,7 @@ void beep(float freq, float duration, int8_t on_position) {
 
 // Logic from https://www.pocketmagic.net/morse-encoder/
 void _morse_char(uint8_t decimal, int8_t on_position) {
+  PROFILE_FUNCTION(PROFILE_MORSE_CHAR);
   if (decimal) {
     if (on_position != get_wheel_pos())
       return;
@@ -445,6 +599,7 @@ void play_fail_sound(int8_t on_position) {
 }
 
 void play_audio(enum position *history) {
+  PROFILE_FUNCTION(PROFILE_PLAY_AUDIO);
   // check if combination for hint was entered
   for (uint8_t k = 0; k < HINT_LENGTH; k++) {
     if (history[k] != HINT_COMBINATION[k])
@@ -494,6 +649,7 @@ void play_audio(enum position *history) {
 }
 
 void push_history(enum position *history, uint8_t value) {
+  PROFILE_FUNCTION(PROFILE_PUSH_HISTORY);
   for (uint8_t k = HISTORY_LENGTH - 1; k > 0; k--)
     history[k] = history[k - 1];
 
@@ -507,12 +663,30 @@ void beep_history(enum position *history) {
   }
 }
 
-void play_song(const __flash float song[][2], int8_t on_position) {
-  for (uint8_t k = 0; song[k][1] >= 0; k++) {
+void play_song(const __flash uint16_t song[][2], int8_t semitones,
+               uint8_t tempo_scale, int8_t on_position) {
+  // split transposition into whole octaves and remaining semitones
+  int8_t octaves = semitones / 12;
+  int8_t remaining = semitones % 12;
+  if (remaining < 0) {
+    remaining += 12;
+    octaves--;
+  }
+  uint16_t factor = SEMITONE_FACTORS[remaining];
+
+  uint32_t freq;
+  uint32_t duration;
+  for (uint8_t k = 0; song[k][1] > 0; k++) {
     if (on_position >= 0 && get_wheel_pos() != on_position) {
       return;
     }
-    beep(song[k][0], song[k][1], on_position);
+    freq = ((uint32_t)song[k][0] * factor) >> 15;
+    if (octaves >= 0)
+      freq <<= octaves;
+    else
+      freq >>= -octaves;
+    duration = ((uint32_t)song[k][1] * tempo_scale) >> SONG_TEMPO_SHIFT;
+    beep((float)freq / (1 << SONG_FREQ_SHIFT), duration, on_position);
   }
 }
 
@@ -529,91 +703,146 @@ void morse_message(uint8_t message_id, int8_t on_position) {
 }
 
 uint8_t get_wheel_pos(void) {
+  PROFILE_FUNCTION(PROFILE_GET_WHEEL_POS);
   return (~PIN(WHEEL_PORT) & WHEEL_MASK) >> WHEEL_BIT_SHIFT_RIGHT;
 }
 
+#ifdef PROFILING
+ISR(TIMER1_OVF_vect) { profile_overflows++; }
+
+void initialize_profiling(void) {
+  // No prescaling: one timer tick per CPU cycle
+  TCCR1B = (1 << CS10);
+  TIMSK |= (1 << TOIE1);
+  sei();
+
+  // time an empty scope to measure the overhead of the profiler
+  {
+    PROFILE_FUNCTION(PROFILE_CALIBRATION);
+  }
+}
+
+uint32_t profile_now(void) {
+  uint8_t sreg = SREG;
+  cli();
+  uint16_t low = TCNT1;
+  uint16_t high = profile_overflows;
+  // The timer might have overflowed after interrupts were disabled
+  if ((TIFR & (1 << TOV1)) && low < 0x8000)
+    high++;
+  SREG = sreg;
+  return ((uint32_t)high << 16) | low;
+}
+
+void profile_stop(struct profile_scope *scope) {
+  uint32_t cycles = profile_now() - scope->start;
+
+  if (scope->id == PROFILE_CALIBRATION) {
+    profile_bias = cycles;
+    return;
+  }
+
+  cycles = cycles > profile_bias ? cycles - profile_bias : 0;
+  struct profile_entry *entry = &profile_table[scope->id];
+
+  entry->count++;
+  if (entry->total + cycles >= entry->total)
+    entry->total += cycles;
+  else
+    entry->total = UINT32_MAX;
+  if (cycles > entry->max)
+    entry->max = cycles;
+}
+
+void profile_dump(void) {
+  eeprom_update_block(profile_table, (void *)PROFILE_EEPROM_ADDRESS,
+                      sizeof(profile_table));
+}
+#endif
+
 // Functions playing hardcoded songs.
 // The song arrays correspond to the csv files in data/
-// The tuples correspond to frequency in Hz, duration in ms
+// The tuples correspond to frequency in units of 1 / 2^SONG_FREQ_SHIFT Hz,
+// duration in ms
 // Zero frequency marks pauses.
-// A negative duration marks the end of the song.
+// A zero duration marks the end of the song.
 
 void play_hint(int8_t on_position) {
-  static const __flash float hint[37][2] = {
-      {261.624, 250},  {261.624, 20},   {280.111, 20},   {299.897, 20},
-      {321.086, 20},   {343.769, 20},   {368.057, 20},   {394.057, 20},
-      {421.899, 20},   {451.707, 20},   {483.618, 20},   {517.786, 20},
-      {554.364, 20},   {554.364, 500},  {523.253, 3000}, {622.254, 250},
-      {622.254, 20},   {569.112, 20},   {520.509, 20},   {476.059, 20},
-      {435.402, 20},   {398.220, 20},   {364.212, 20},   {333.106, 20},
-      {304.659, 20},   {278.644, 20},   {254.843, 20},   {233.082, 20},
-      {233.082, 500},  {261.624, 4000}, {523.253, 750},  {415.304, 250},
-      {261.624, 1000}, {311.127, 750},  {277.182, 250},  {261.624, 1000},
-      {0.0, -1.0}};
-  play_song(hint, on_position);
+  static const __flash uint16_t hint[37][2] = {
+      {4186, 250},  {4186, 20},   {4482, 20},   {4798, 20},
+      {5137, 20},   {5500, 20},   {5889, 20},   {6305, 20},
+      {6750, 20},   {7227, 20},   {7738, 20},   {8285, 20},
+      {8870, 20},   {8870, 500},  {8372, 3000}, {9956, 250},
+      {9956, 20},   {9106, 20},   {8328, 20},   {7617, 20},
+      {6966, 20},   {6372, 20},   {5827, 20},   {5330, 20},
+      {4875, 20},   {4458, 20},   {4077, 20},   {3729, 20},
+      {3729, 500},  {4186, 4000}, {8372, 750},  {6645, 250},
+      {4186, 1000}, {4978, 750},  {4435, 250},  {4186, 1000},
+      {0, 0}};
+  play_song(hint, 0, SONG_TEMPO_UNIT, on_position);
 }
 
 void play_song0(int8_t on_position) {
-  static const __flash float song0[51][2] = {
-      {311.129, 190}, {0.000, 10}, {311.129, 190}, {0.000, 10},
-      {349.229, 390}, {0.000, 10}, {311.129, 390}, {0.000, 10},
-      {415.305, 390}, {0.000, 10}, {391.996, 790}, {0.000, 10},
-      {311.129, 190}, {0.000, 10}, {311.129, 190}, {0.000, 10},
-      {349.229, 390}, {0.000, 10}, {311.129, 390}, {0.000, 10},
-      {466.165, 390}, {0.000, 10}, {415.305, 790}, {0.000, 10},
-      {311.129, 190}, {0.000, 10}, {311.129, 190}, {0.000, 10},
-      {622.254, 390}, {0.000, 10}, {523.251, 390}, {0.000, 10},
-      {415.305, 390}, {0.000, 10}, {391.996, 390}, {0.000, 10},
-      {349.229, 390}, {0.000, 10}, {554.366, 190}, {0.000, 10},
-      {554.366, 190}, {0.000, 10}, {523.251, 390}, {0.000, 10},
-      {415.305, 390}, {0.000, 10}, {466.165, 390}, {0.000, 10},
-      {415.305, 790}, {0.000, 10}, {0.0, -1.0}};
-
-  play_song(song0, on_position);
+  static const __flash uint16_t song0[51][2] = {
+      {4978, 190}, {0, 10}, {4978, 190}, {0, 10},
+      {5588, 390}, {0, 10}, {4978, 390}, {0, 10},
+      {6645, 390}, {0, 10}, {6272, 790}, {0, 10},
+      {4978, 190}, {0, 10}, {4978, 190}, {0, 10},
+      {5588, 390}, {0, 10}, {4978, 390}, {0, 10},
+      {7459, 390}, {0, 10}, {6645, 790}, {0, 10},
+      {4978, 190}, {0, 10}, {4978, 190}, {0, 10},
+      {9956, 390}, {0, 10}, {8372, 390}, {0, 10},
+      {6645, 390}, {0, 10}, {6272, 390}, {0, 10},
+      {5588, 390}, {0, 10}, {8870, 190}, {0, 10},
+      {8870, 190}, {0, 10}, {8372, 390}, {0, 10},
+      {6645, 390}, {0, 10}, {7459, 390}, {0, 10},
+      {6645, 790}, {0, 10}, {0, 0}};
+
+  play_song(song0, 0, SONG_TEMPO_UNIT, on_position);
 }
 void play_song1(int8_t on_position) {
-  static const __flash float song1[51][2] = {
-      {440.000, 390}, {0.000, 10}, {587.330, 390}, {0.000, 10},
-      {554.370, 390}, {0.000, 10}, {493.880, 190}, {0.000, 10},
-      {554.370, 190}, {0.000, 10}, {587.330, 390}, {0.000, 10},
-      {440.000, 390}, {0.000, 10}, {440.000, 390}, {0.000, 10},
-      {493.880, 390}, {0.000, 10}, {440.000, 390}, {0.000, 10},
-      {392.000, 390}, {0.000, 10}, {369.990, 390}, {0.000, 10},
-      {440.000, 390}, {0.000, 10}, {369.990, 390}, {0.000, 10},
-      {392.000, 390}, {0.000, 10}, {440.000, 390}, {0.000, 10},
-      {493.880, 390}, {0.000, 10}, {440.000, 390}, {0.000, 10},
-      {369.990, 390}, {0.000, 10}, {440.000, 390}, {0.000, 10},
-      {392.000, 190}, {0.000, 10}, {369.990, 190}, {0.000, 10},
-      {329.630, 390}, {0.000, 10}, {329.630, 390}, {0.000, 10},
-      {293.660, 790}, {0.000, 10}, {0.0, -1.0}};
-  play_song(song1, on_position);
+  static const __flash uint16_t song1[51][2] = {
+      {7040, 390}, {0, 10}, {9397, 390}, {0, 10},
+      {8870, 390}, {0, 10}, {7902, 190}, {0, 10},
+      {8870, 190}, {0, 10}, {9397, 390}, {0, 10},
+      {7040, 390}, {0, 10}, {7040, 390}, {0, 10},
+      {7902, 390}, {0, 10}, {7040, 390}, {0, 10},
+      {6272, 390}, {0, 10}, {5920, 390}, {0, 10},
+      {7040, 390}, {0, 10}, {5920, 390}, {0, 10},
+      {6272, 390}, {0, 10}, {7040, 390}, {0, 10},
+      {7902, 390}, {0, 10}, {7040, 390}, {0, 10},
+      {5920, 390}, {0, 10}, {7040, 390}, {0, 10},
+      {6272, 190}, {0, 10}, {5920, 190}, {0, 10},
+      {5274, 390}, {0, 10}, {5274, 390}, {0, 10},
+      {4699, 790}, {0, 10}, {0, 0}};
+  play_song(song1, 0, SONG_TEMPO_UNIT, on_position);
 }
 
 void play_song2(int8_t on_position) {
-  static const __flash float song2[93][2] = {
-      {369.994, 190}, {0.000, 10}, {369.994, 190},  {0.000, 10},
-      {415.302, 190}, {0.000, 10}, {466.168, 390},  {0.000, 10},
-      {466.168, 190}, {0.000, 10}, {466.168, 190},  {0.000, 10},
-      {466.168, 190}, {0.000, 10}, {369.994, 190},  {0.000, 10},
-      {415.302, 190}, {0.000, 10}, {466.168, 190},  {0.000, 10},
-      {493.884, 590}, {0.000, 10}, {493.884, 190},  {0.000, 10},
-      {493.884, 190}, {0.000, 10}, {415.302, 190},  {0.000, 10},
-      {466.168, 190}, {0.000, 10}, {493.884, 190},  {0.000, 10},
-      {554.369, 390}, {0.000, 10}, {554.369, 190},  {0.000, 10},
-      {554.369, 190}, {0.000, 10}, {554.369, 190},  {0.000, 10},
-      {554.369, 190}, {0.000, 10}, {554.369, 190},  {0.000, 10},
-      {622.255, 190}, {0.000, 10}, {493.884, 390},  {0.000, 10},
-      {493.884, 190}, {0.000, 10}, {493.884, 190},  {0.000, 10},
-      {493.884, 190}, {0.000, 10}, {466.168, 190},  {0.000, 10},
-      {415.302, 190}, {0.000, 10}, {369.994, 190},  {0.000, 10},
-      {466.168, 390}, {0.000, 10}, {466.168, 190},  {0.000, 10},
-      {466.168, 190}, {0.000, 10}, {493.884, 190},  {0.000, 10},
-      {466.168, 190}, {0.000, 10}, {415.302, 190},  {0.000, 10},
-      {369.994, 190}, {0.000, 10}, {415.302, 390},  {0.000, 10},
-      {415.302, 190}, {0.000, 10}, {415.302, 190},  {0.000, 10},
-      {415.302, 190}, {0.000, 10}, {415.302, 190},  {0.000, 10},
-      {415.302, 190}, {0.000, 10}, {466.168, 190},  {0.000, 10},
-      {415.302, 390}, {0.000, 10}, {369.994, 1190}, {0.000, 10},
-      {0.0, -1.0}};
-  play_song(song2, on_position);
+  static const __flash uint16_t song2[93][2] = {
+      {5920, 190}, {0, 10}, {5920, 190},  {0, 10},
+      {6645, 190}, {0, 10}, {7459, 390},  {0, 10},
+      {7459, 190}, {0, 10}, {7459, 190},  {0, 10},
+      {7459, 190}, {0, 10}, {5920, 190},  {0, 10},
+      {6645, 190}, {0, 10}, {7459, 190},  {0, 10},
+      {7902, 590}, {0, 10}, {7902, 190},  {0, 10},
+      {7902, 190}, {0, 10}, {6645, 190},  {0, 10},
+      {7459, 190}, {0, 10}, {7902, 190},  {0, 10},
+      {8870, 390}, {0, 10}, {8870, 190},  {0, 10},
+      {8870, 190}, {0, 10}, {8870, 190},  {0, 10},
+      {8870, 190}, {0, 10}, {8870, 190},  {0, 10},
+      {9956, 190}, {0, 10}, {7902, 390},  {0, 10},
+      {7902, 190}, {0, 10}, {7902, 190},  {0, 10},
+      {7902, 190}, {0, 10}, {7459, 190},  {0, 10},
+      {6645, 190}, {0, 10}, {5920, 190},  {0, 10},
+      {7459, 390}, {0, 10}, {7459, 190},  {0, 10},
+      {7459, 190}, {0, 10}, {7902, 190},  {0, 10},
+      {7459, 190}, {0, 10}, {6645, 190},  {0, 10},
+      {5920, 190}, {0, 10}, {6645, 390},  {0, 10},
+      {6645, 190}, {0, 10}, {6645, 190},  {0, 10},
+      {6645, 190}, {0, 10}, {6645, 190},  {0, 10},
+      {6645, 190}, {0, 10}, {7459, 190},  {0, 10},
+      {6645, 390}, {0, 10}, {5920, 1190}, {0, 10},
+      {0, 0}};
+  play_song(song2, 0, SONG_TEMPO_UNIT, on_position);
 }
@@ -2,6 +2,9 @@
 using Printf
 
 max_freq = 600
+# frequencies are stored in units of 1 / 2^freq_shift Hz (SONG_FREQ_SHIFT in
+# code/main.c)
+freq_shift = 4
 
 output_file = "songs.c"
 input_files = ["song_hint.csv", "song0.csv", "song1.csv", "song2.csv"]
@@ -27,11 +30,12 @@ open(output_file, "w") do out
         shift = minimum(necessary_shift.(notes, max_freq))
         notes = transpose.(notes, discretize_to_halftones(shift))
 
-        println(out, "float $var_name[$len][2] = {")
+        println(out, "uint16_t $var_name[$len][2] = {")
         for note in notes
-            println(out, (@sprintf "    {%.3f, %3d}," note[1] note[2]))
+            freq = round(Int, note[1] * 2^freq_shift)
+            println(out, (@sprintf "    {%5d, %4d}," freq note[2]))
         end
-        println(out, "    {0.0, -1.0}\n};")
+        println(out, "    {0, 0}\n};")
         println(out)
     end
 end
@@ -1,64 +1,67 @@
-float hint[37][2] = {
-    {261.624, 250},  {261.624, 20},   {280.111, 20},   {299.897, 20},
-    {321.086, 20},   {343.769, 20},   {368.057, 20},   {394.057, 20},
-    {421.899, 20},   {451.707, 20},   {483.618, 20},   {517.786, 20},
-    {554.364, 20},   {554.364, 500},  {523.253, 3000}, {622.254, 250},
-    {622.254, 20},   {569.112, 20},   {520.509, 20},   {476.059, 20},
-    {435.402, 20},   {398.220, 20},   {364.212, 20},   {333.106, 20},
-    {304.659, 20},   {278.644, 20},   {254.843, 20},   {233.082, 20},
-    {233.082, 500},  {261.624, 4000}, {523.253, 750},  {415.304, 250},
-    {261.624, 1000}, {311.127, 750},  {277.182, 250},  {261.624, 1000},
-    {0.0, -1.0}};
+uint16_t hint[37][2] = {
+    {4186, 250},  {4186, 20},   {4482, 20},   {4798, 20},
+    {5137, 20},   {5500, 20},   {5889, 20},   {6305, 20},
+    {6750, 20},   {7227, 20},   {7738, 20},   {8285, 20},
+    {8870, 20},   {8870, 500},  {8372, 3000}, {9956, 250},
+    {9956, 20},   {9106, 20},   {8328, 20},   {7617, 20},
+    {6966, 20},   {6372, 20},   {5827, 20},   {5330, 20},
+    {4875, 20},   {4458, 20},   {4077, 20},   {3729, 20},
+    {3729, 500},  {4186, 4000}, {8372, 750},  {6645, 250},
+    {4186, 1000}, {4978, 750},  {4435, 250},  {4186, 1000},
+    {0, 0}};
 
-float song0[51][2] = {{311.129, 190}, {0.000, 10}, {311.129, 190}, {0.000, 10},
-                      {349.229, 390}, {0.000, 10}, {311.129, 390}, {0.000, 10},
-                      {415.305, 390}, {0.000, 10}, {391.996, 790}, {0.000, 10},
-                      {311.129, 190}, {0.000, 10}, {311.129, 190}, {0.000, 10},
-                      {349.229, 390}, {0.000, 10}, {311.129, 390}, {0.000, 10},
-                      {466.165, 390}, {0.000, 10}, {415.305, 790}, {0.000, 10},
-                      {311.129, 190}, {0.000, 10}, {311.129, 190}, {0.000, 10},
-                      {622.254, 390}, {0.000, 10}, {523.251, 390}, {0.000, 10},
-                      {415.305, 390}, {0.000, 10}, {391.996, 390}, {0.000, 10},
-                      {349.229, 390}, {0.000, 10}, {554.366, 190}, {0.000, 10},
-                      {554.366, 190}, {0.000, 10}, {523.251, 390}, {0.000, 10},
-                      {415.305, 390}, {0.000, 10}, {466.165, 390}, {0.000, 10},
-                      {415.305, 790}, {0.000, 10}, {0.0, -1.0}};
+uint16_t song0[51][2] = {
+    {4978, 190}, {0, 10}, {4978, 190}, {0, 10},
+    {5588, 390}, {0, 10}, {4978, 390}, {0, 10},
+    {6645, 390}, {0, 10}, {6272, 790}, {0, 10},
+    {4978, 190}, {0, 10}, {4978, 190}, {0, 10},
+    {5588, 390}, {0, 10}, {4978, 390}, {0, 10},
+    {7459, 390}, {0, 10}, {6645, 790}, {0, 10},
+    {4978, 190}, {0, 10}, {4978, 190}, {0, 10},
+    {9956, 390}, {0, 10}, {8372, 390}, {0, 10},
+    {6645, 390}, {0, 10}, {6272, 390}, {0, 10},
+    {5588, 390}, {0, 10}, {8870, 190}, {0, 10},
+    {8870, 190}, {0, 10}, {8372, 390}, {0, 10},
+    {6645, 390}, {0, 10}, {7459, 390}, {0, 10},
+    {6645, 790}, {0, 10}, {0, 0}};
 
-float song1[51][2] = {{440.000, 390}, {0.000, 10}, {587.330, 390}, {0.000, 10},
-                      {554.370, 390}, {0.000, 10}, {493.880, 190}, {0.000, 10},
-                      {554.370, 190}, {0.000, 10}, {587.330, 390}, {0.000, 10},
-                      {440.000, 390}, {0.000, 10}, {440.000, 390}, {0.000, 10},
-                      {493.880, 390}, {0.000, 10}, {440.000, 390}, {0.000, 10},
-                      {392.000, 390}, {0.000, 10}, {369.990, 390}, {0.000, 10},
-                      {440.000, 390}, {0.000, 10}, {369.990, 390}, {0.000, 10},
-                      {392.000, 390}, {0.000, 10}, {440.000, 390}, {0.000, 10},
-                      {493.880, 390}, {0.000, 10}, {440.000, 390}, {0.000, 10},
-                      {369.990, 390}, {0.000, 10}, {440.000, 390}, {0.000, 10},
-                      {392.000, 190}, {0.000, 10}, {369.990, 190}, {0.000, 10},
-                      {329.630, 390}, {0.000, 10}, {329.630, 390}, {0.000, 10},
-                      {293.660, 790}, {0.000, 10}, {0.0, -1.0}};
+uint16_t song1[51][2] = {
+    {7040, 390}, {0, 10}, {9397, 390}, {0, 10},
+    {8870, 390}, {0, 10}, {7902, 190}, {0, 10},
+    {8870, 190}, {0, 10}, {9397, 390}, {0, 10},
+    {7040, 390}, {0, 10}, {7040, 390}, {0, 10},
+    {7902, 390}, {0, 10}, {7040, 390}, {0, 10},
+    {6272, 390}, {0, 10}, {5920, 390}, {0, 10},
+    {7040, 390}, {0, 10}, {5920, 390}, {0, 10},
+    {6272, 390}, {0, 10}, {7040, 390}, {0, 10},
+    {7902, 390}, {0, 10}, {7040, 390}, {0, 10},
+    {5920, 390}, {0, 10}, {7040, 390}, {0, 10},
+    {6272, 190}, {0, 10}, {5920, 190}, {0, 10},
+    {5274, 390}, {0, 10}, {5274, 390}, {0, 10},
+    {4699, 790}, {0, 10}, {0, 0}};
 
-float song2[93][2] = {{369.994, 190}, {0.000, 10}, {369.994, 190},  {0.000, 10},
-                      {415.302, 190}, {0.000, 10}, {466.168, 390},  {0.000, 10},
-                      {466.168, 190}, {0.000, 10}, {466.168, 190},  {0.000, 10},
-                      {466.168, 190}, {0.000, 10}, {369.994, 190},  {0.000, 10},
-                      {415.302, 190}, {0.000, 10}, {466.168, 190},  {0.000, 10},
-                      {493.884, 590}, {0.000, 10}, {493.884, 190},  {0.000, 10},
-                      {493.884, 190}, {0.000, 10}, {415.302, 190},  {0.000, 10},
-                      {466.168, 190}, {0.000, 10}, {493.884, 190},  {0.000, 10},
-                      {554.369, 390}, {0.000, 10}, {554.369, 190},  {0.000, 10},
-                      {554.369, 190}, {0.000, 10}, {554.369, 190},  {0.000, 10},
-                      {554.369, 190}, {0.000, 10}, {554.369, 190},  {0.000, 10},
-                      {622.255, 190}, {0.000, 10}, {493.884, 390},  {0.000, 10},
-                      {493.884, 190}, {0.000, 10}, {493.884, 190},  {0.000, 10},
-                      {493.884, 190}, {0.000, 10}, {466.168, 190},  {0.000, 10},
-                      {415.302, 190}, {0.000, 10}, {369.994, 190},  {0.000, 10},
-                      {466.168, 390}, {0.000, 10}, {466.168, 190},  {0.000, 10},
-                      {466.168, 190}, {0.000, 10}, {493.884, 190},  {0.000, 10},
-                      {466.168, 190}, {0.000, 10}, {415.302, 190},  {0.000, 10},
-                      {369.994, 190}, {0.000, 10}, {415.302, 390},  {0.000, 10},
-                      {415.302, 190}, {0.000, 10}, {415.302, 190},  {0.000, 10},
-                      {415.302, 190}, {0.000, 10}, {415.302, 190},  {0.000, 10},
-                      {415.302, 190}, {0.000, 10}, {466.168, 190},  {0.000, 10},
-                      {415.302, 390}, {0.000, 10}, {369.994, 1190}, {0.000, 10},
-                      {0.0, -1.0}};
+uint16_t song2[93][2] = {
+    {5920, 190}, {0, 10}, {5920, 190},  {0, 10},
+    {6645, 190}, {0, 10}, {7459, 390},  {0, 10},
+    {7459, 190}, {0, 10}, {7459, 190},  {0, 10},
+    {7459, 190}, {0, 10}, {5920, 190},  {0, 10},
+    {6645, 190}, {0, 10}, {7459, 190},  {0, 10},
+    {7902, 590}, {0, 10}, {7902, 190},  {0, 10},
+    {7902, 190}, {0, 10}, {6645, 190},  {0, 10},
+    {7459, 190}, {0, 10}, {7902, 190},  {0, 10},
+    {8870, 390}, {0, 10}, {8870, 190},  {0, 10},
+    {8870, 190}, {0, 10}, {8870, 190},  {0, 10},
+    {8870, 190}, {0, 10}, {8870, 190},  {0, 10},
+    {9956, 190}, {0, 10}, {7902, 390},  {0, 10},
+    {7902, 190}, {0, 10}, {7902, 190},  {0, 10},
+    {7902, 190}, {0, 10}, {7459, 190},  {0, 10},
+    {6645, 190}, {0, 10}, {5920, 190},  {0, 10},
+    {7459, 390}, {0, 10}, {7459, 190},  {0, 10},
+    {7459, 190}, {0, 10}, {7902, 190},  {0, 10},
+    {7459, 190}, {0, 10}, {6645, 190},  {0, 10},
+    {5920, 190}, {0, 10}, {6645, 390},  {0, 10},
+    {6645, 190}, {0, 10}, {6645, 190},  {0, 10},
+    {6645, 190}, {0, 10}, {6645, 190},  {0, 10},
+    {6645, 190}, {0, 10}, {7459, 190},  {0, 10},
+    {6645, 390}, {0, 10}, {5920, 1190}, {0, 10},
+    {0, 0}};